@@ -26,7 +26,7 @@ public:
 
 	~XClipboard() { XCloseDisplay(dpy); }
 
-	bool waitPaste(std::string clipboard) {
+	bool waitPaste(const std::string& clipboard) {
 		const Atom targets[2] = { atoms.targets, atoms.utf8str };
 
 		XSetSelectionOwner(dpy, atoms.clipboard, win, CurrentTime);
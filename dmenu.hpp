@@ -3,6 +3,7 @@
 #include "execWrapper.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 
 struct DmenuFlags {
@@ -35,7 +36,7 @@ struct DmenuFlags {
 
 class Dmenu {
 	Process dmenuProcess;
-	std::vector<std::string> options;
+	std::vector<std::string_view> options;
 	bool done = false;
 	std::string out;
 	int exitCode;
@@ -52,7 +53,8 @@ class Dmenu {
 		return out;
 	}
 public:
-	Dmenu(const std::vector<std::string>& options, const DmenuFlags& flags = {}) : dmenuProcess("dmenu", flags.getFlagsVec()), options(options) {}
+	// The options are not copied, they must outlive the call to result()
+	Dmenu(std::vector<std::string_view> options, const DmenuFlags& flags = {}) : dmenuProcess("dmenu", flags.getFlagsVec()), options(std::move(options)) {}
 
 	std::string result() {
 		if (!done) {
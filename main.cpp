@@ -1,75 +1,71 @@
 #include "passwordStore.hpp"
-#include "passwordGenerator.hpp"
 #include "XClipboard.hpp"
 #include "dmenu.hpp"
 #include "notifications.hpp"
+#include "passwordAudit.hpp"
+#include "passwordPolicy.hpp"
 
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <random>
 #include <optional>
 #include <functional>
+#include <memory>
+#include <unordered_map>
 #include <stdexcept>
 
 using namespace std::literals;
 
 const int maxLines = 20;
+const int weakStrength = 50;
+const int defaultDicewareWords = 6;
 const DmenuFlags defaultFlags = { .showPos = DmenuFlags::CENTER };
 
-constexpr static auto generators = passwordGeneratorList(
-	[] { return "!-~"sv; },
-	[] { return "0-9A-Za-z!?+_()"sv; }
-);
+constexpr static std::array policies = {
+	PasswordPolicy("printable", { lowercaseClass, uppercaseClass, digitClass, symbolClass }, 10),
+	PasswordPolicy("simple", { lowercaseClass, uppercaseClass, digitClass, "!?+_()" }, 10),
+};
 
 using namespace std::placeholders;
 
 PasswordStore passwordStore;
-XClipboard clipboard;
 Notifications notifier("passDmenu");
 
-template<typename T>
 struct DmenuResult {
 	std::string value, flags;
-	std::optional<T> entry;
+	std::optional<uint32_t> index;
 
-	DmenuResult(const std::string& inValue, const std::vector<T>& entries, std::function<bool(const std::string&, const T&)> predicate) {
+	DmenuResult(const std::string& inValue, std::function<std::optional<uint32_t>(std::string_view)> lookup) {
 		auto slashPos = std::find(begin(inValue), end(inValue), '/');
 		value = std::string(begin(inValue), slashPos);
 		if (slashPos != end(inValue)) flags = std::string(slashPos, end(inValue));
 
-		auto entryIt = std::find_if(begin(entries), end(entries), std::bind(predicate, value, _1));
-		if (entryIt != end(entries)) entry = *entryIt;
+		index = lookup(value);
 	}
 
 	bool isEmpty() { return value.empty() && flags.empty(); }
-	bool isCommand() { return !entry || !flags.empty(); }
+	bool isCommand() { return !index || !flags.empty(); }
 
-	T& operator*() { return *entry; }
-	T* operator->() { return &*entry; }
+	uint32_t operator*() { return index.value(); }
 };
 
-DmenuResult<std::vector<PasswordEntry>> askService(std::vector<std::vector<PasswordEntry>>& services) {
-	std::vector<std::string> serviceOptions(services.size());
-	std::transform(begin(services), end(services), begin(serviceOptions), [](const auto& service){  return service[0].service; });
-
+DmenuResult askService(const PasswordCatalog& catalog) {
 	DmenuFlags flags = defaultFlags;
-	flags.lines = std::min((int)services.size(), maxLines);
-	Dmenu d(serviceOptions, flags);
+	flags.lines = std::min((int)catalog.serviceCount(), maxLines);
+	Dmenu d(catalog.serviceNames(), flags);
 
-	return DmenuResult<std::vector<PasswordEntry>>(d.result(), services, [](const auto& needle, const auto& v) { return v[0].service == needle; });
+	return DmenuResult(d.result(), [&](std::string_view needle) { return catalog.findService(needle); });
 }
 
-DmenuResult<PasswordEntry> askUser(std::vector<PasswordEntry> users) {
-	std::vector<std::string> userOptions(users.size());
-	std::transform(begin(users), end(users), begin(userOptions), [](const auto& entry){ return entry.username; });
-
+DmenuResult askUser(const PasswordCatalog& catalog, uint32_t service) {
 	DmenuFlags flags = defaultFlags;
-	flags.lines = std::min((int)users.size(), maxLines);
+	flags.lines = std::min((int)catalog.entryCount(service), maxLines);
 	flags.prompt = "User:";
-	Dmenu d(userOptions, flags);
+	Dmenu d(catalog.usernames(service), flags);
 
-	return DmenuResult<PasswordEntry>(d.result(), users, [](const auto& needle, const auto& v) { return v.username == needle; });
+	return DmenuResult(d.result(), [&](std::string_view needle) { return catalog.findEntry(service, needle); });
 }
 
 bool askYesNo(std::string prompt, std::string yesOption = "Yes", std::string noOption = "No") {
@@ -87,23 +83,83 @@ std::string askValue(std::string prompt) {
 	Dmenu d({}, flags);
 	return d.result();
 }
-std::string askPassword(std::string prompt) {
-	std::mt19937 rng(std::random_device{}());
-	std::vector<std::string> suggestions(generators.size());
-	std::transform(begin(generators), end(generators), begin(suggestions), [&rng](const auto& gen){ return gen(rng, 10); });
+// The wordlist of the rule or of the store if present, otherwise the built in one.
+// Like the rules file a relative path is in the store
+std::unique_ptr<Wordlist> loadWordlist(const ServiceRule* rule) {
+	bool hasRuleWordlist = rule && !rule->wordlist.empty();
+	fs::path path = passwordStore.path() / (hasRuleWordlist ? fs::path(rule->wordlist) : fs::path(".wordlist"));
+	if (hasRuleWordlist || fs::exists(path)) {
+		try {
+			return std::make_unique<Wordlist>(path);
+		} catch (const std::exception& e) {
+			notifier.create("passDmenu", std::string(e.what()) + ", using the built in wordlist").timeout(5000).show();
+		}
+	}
+	return std::make_unique<Wordlist>();
+}
+
+std::string askPassword(std::string prompt, const std::string& service) {
+	// Drawing from the system source directly, a seeded engine would cap the entropy to the seed size
+	std::random_device rng;
+	std::vector<std::string> suggestions, labels;
+	const auto addSuggestion = [&](std::string password, double entropy) {
+		labels.push_back(password + "  (" + std::to_string((int)entropy) + " bits)");
+		suggestions.push_back(std::move(password));
+	};
+
+	const auto suggest = [&](const ServiceRule* rule) {
+		bool dicewareOnly = rule && rule->dicewareWords > 0;
+		if (!dicewareOnly) {
+			for (const auto& policy : policies) {
+				if (rule && !rule->policy.empty() && rule->policy != policy.name()) continue;
+				auto servicePolicy = rule ? rule->apply(policy) : policy;
+				addSuggestion(servicePolicy(rng), servicePolicy.entropy());
+			}
+			if (suggestions.empty()) throw std::runtime_error("Unknown policy " + rule->policy);
+		}
+
+		auto wordlist = loadWordlist(rule);
+		if (dicewareOnly) {
+			auto passphrase = rule->passphrase(*wordlist);
+			addSuggestion(passphrase(rng), passphrase.entropy());
+		} else {
+			// The default passphrase is only offered when it meets the max and ban of the rule and is still strong
+			ServiceRule defaultRule = rule ? *rule : ServiceRule();
+			defaultRule.dicewareWords = defaultDicewareWords;
+			try {
+				auto passphrase = defaultRule.passphrase(*wordlist);
+				if (passphrase.entropy() >= weakStrength) addSuggestion(passphrase(rng), passphrase.entropy());
+			} catch (const std::invalid_argument&) {}
+		}
+	};
+
+	// Like a broken wordlist, broken rules must not stop the menu
+	try {
+		PolicyRules rules(passwordStore.path() / ".dmenupass-rules");
+		suggest(rules.find(service));
+	} catch (const std::exception& e) {
+		notifier.create("passDmenu", std::string(e.what()) + ", using the built in policies").timeout(5000).show();
+		suggestions.clear();
+		labels.clear();
+		suggest(nullptr);
+	}
 
 	DmenuFlags flags = defaultFlags;
-	flags.lines = 2;
+	flags.lines = labels.size();
 	if (!prompt.empty()) flags.prompt = prompt;
-	Dmenu d(suggestions, flags);
-	return d.result();
+	Dmenu d({ begin(labels), end(labels) }, flags);
+
+	std::string result = d.result();
+	auto labelIt = std::find(begin(labels), end(labels), result);
+	if (labelIt != end(labels)) return suggestions[labelIt - begin(labels)];
+	return result;
 }
 
-int handleUserCommand(const std::string& service, DmenuResult<PasswordEntry>& result) {
+int handleUserCommand(const PasswordCatalog& catalog, const std::string& service, DmenuResult& result) {
 	if (result.flags.empty()) {
 		if (!askYesNo("Do you want to:", "Add " + result.value + " to " + service, "Exit")) return EXIT_SUCCESS;
 		
-		std::string password = askPassword("Enter Password:");
+		std::string password = askPassword("Enter Password:", service);
 
 		PasswordEntry newEntry(result.value, result.value, password);
 		passwordStore.serializeEntry(newEntry, notifier);
@@ -112,9 +168,11 @@ int handleUserCommand(const std::string& service, DmenuResult<PasswordEntry>& re
 	}
 
 	if (result.flags == "/e") {
-		PasswordEntry toEdit = *result;
+		if (!result.index) throw std::runtime_error("Cannot edit unknown user " + result.value);
+
+		PasswordEntry toEdit(catalog, *result);
 		passwordStore.decryptEntry(toEdit);
-		toEdit.password = askPassword("New Password:");
+		toEdit.password = askPassword("New Password:", toEdit.service);
 		passwordStore.serializeEntry(toEdit, notifier);
 		return EXIT_SUCCESS;
 	}
@@ -122,13 +180,13 @@ int handleUserCommand(const std::string& service, DmenuResult<PasswordEntry>& re
 	return EXIT_FAILURE;
 }
 
-int handleServiceCommand(DmenuResult<std::vector<PasswordEntry>>& result) {
+int handleServiceCommand(const PasswordCatalog& catalog, DmenuResult& result) {
 	if (result.flags == "/e") {
-		if (result->size() != 1) throw std::runtime_error("Cannot edit service directory");
+		if (!result.index || catalog.entryCount(*result) != 1) throw std::runtime_error("Cannot edit service directory");
 
-		PasswordEntry toEdit = result->at(0);
+		PasswordEntry toEdit(catalog, catalog.firstEntry(*result));
 		passwordStore.decryptEntry(toEdit);
-		toEdit.password = askPassword("New Password:");
+		toEdit.password = askPassword("New Password:", toEdit.service);
 		passwordStore.serializeEntry(toEdit, notifier);
 		return EXIT_SUCCESS;
 	}
@@ -147,7 +205,7 @@ int handleServiceCommand(DmenuResult<std::vector<PasswordEntry>>& result) {
 		std::string username = askValue("Enter Username:");
 		if (username.empty()) return EXIT_FAILURE; // TODO: notify this
 
-		std::string password = askPassword("Enter Password:");
+		std::string password = askPassword("Enter Password:", service);
 
 		PasswordEntry newEntry(service, username, password);
 		passwordStore.serializeEntry(newEntry, notifier);
@@ -157,8 +215,10 @@ int handleServiceCommand(DmenuResult<std::vector<PasswordEntry>>& result) {
 	return EXIT_FAILURE;
 }
 
-void copyInfo(PasswordEntry& entry) {
+void copyInfo(const PasswordCatalog& catalog, size_t index) {
+	PasswordEntry entry(catalog, index);
 	passwordStore.decryptEntry(entry);
+	XClipboard clipboard;
 	auto userNotification = notifier.create("Copied username", "Copied username for " + entry.service).timeout(5000).show();
 	if (!clipboard.waitPaste(entry.username)) return;
 	userNotification.clear();
@@ -166,23 +226,202 @@ void copyInfo(PasswordEntry& entry) {
 	clipboard.waitPaste(entry.password);
 }
 
-int main() {
-	auto entries = passwordStore.getEntries();
+// A query is "service/user" or just "service" when it has a single entry
+std::optional<uint32_t> findQueryEntry(const PasswordCatalog& catalog, std::string_view query) {
+	size_t slashPos = query.find('/');
+	if (slashPos != std::string_view::npos) return catalog.findEntry(query.substr(0, slashPos), query.substr(slashPos + 1));
+
+	auto service = catalog.findService(query);
+	if (!service || catalog.entryCount(*service) != 1) return std::nullopt;
+	return catalog.firstEntry(*service);
+}
+
+// Prints one line for each query in order, failed queries print an empty line and an error on stderr.
+// The "contents" field has no line framing, the whole decrypted file is streamed only for a single query
+int getCommand(const std::vector<std::string>& args) {
+	struct Query { std::string name, field = "password"; };
+	std::vector<Query> queries;
+	std::vector<std::string> lines;
+
+	if (args.empty()) {
+		std::string line;
+		while (std::getline(std::cin, line)) {
+			line.erase(std::find_if_not(line.rbegin(), line.rend(), isspace).base(), end(line));
+			if (!line.empty()) lines.push_back(std::move(line));
+		}
+	} else if (args.size() <= 2) {
+		queries.push_back({ args[0], args.size() == 2 ? args[1] : "password" });
+	} else {
+		std::cerr << "Usage: dmenupass get [service/user [field]]\n";
+		return EXIT_FAILURE;
+	}
+
+	auto catalog = passwordStore.getEntries();
+
+	if (!args.empty() && queries[0].field == "contents") {
+		auto entry = findQueryEntry(catalog, queries[0].name);
+		try {
+			if (!entry) throw std::runtime_error("Entry not found");
+			passwordStore.decryptContents(catalog.path(*entry), STDOUT_FILENO);
+		} catch (const std::exception& e) {
+			std::cerr << queries[0].name << ": " << e.what() << '\n';
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	// Names can contain spaces, a line is "name<TAB>field", or the whole line when it is an entry,
+	// otherwise the field is after the last whitespace
+	for (auto& line : lines) {
+		size_t separatorPos = line.rfind('\t');
+		if (separatorPos == std::string::npos && !findQueryEntry(catalog, line)) {
+			auto lastSpace = std::find_if(line.rbegin(), line.rend(), isspace);
+			if (lastSpace != line.rend()) separatorPos = line.rend() - lastSpace - 1;
+		}
+
+		Query query;
+		query.name = line.substr(0, separatorPos);
+		if (separatorPos != std::string::npos) query.field = line.substr(separatorPos + 1);
+		query.name.erase(std::find_if_not(query.name.rbegin(), query.name.rend(), isspace).base(), end(query.name));
+		queries.push_back(std::move(query));
+	}
+
+	std::vector<std::optional<std::string>> errors(queries.size());
+	std::vector<FieldRequest> requests;
+	std::vector<size_t> requestQuery;
+	for (size_t i = 0; i < queries.size(); i++) {
+		auto entry = findQueryEntry(catalog, queries[i].name);
+		if (!entry) {
+			errors[i] = "Entry not found";
+			continue;
+		}
+		if (queries[i].field == "contents") {
+			errors[i] = "The contents are only available for a single query";
+			continue;
+		}
+
+		// Like decryptEntry the username of a directory entry defaults to the file name
+		std::optional<std::string> fallback;
+		if (queries[i].field == "username" && !catalog.isServiceFile(*entry)) fallback = std::string(catalog.username(*entry));
+		requests.push_back({ catalog.path(*entry), queries[i].field, std::move(fallback) });
+		requestQuery.push_back(i);
+	}
+
+	bool failed = false;
+	size_t nextQuery = 0;
+	const auto printFailure = [&](const std::string& error) {
+		std::cerr << queries[nextQuery].name << ": " << error << '\n';
+		std::cout << '\n';
+		failed = true;
+	};
+	// Queries that failed before decrypting
+	const auto printErrors = [&](size_t end) {
+		for (; nextQuery < end; nextQuery++) printFailure(*errors[nextQuery]);
+	};
+
+	passwordStore.decryptFields(requests, [&](size_t i, const FieldResult& result) {
+		printErrors(requestQuery[i]);
+		if (result.found) std::cout << result.value << '\n';
+		else printFailure(result.value);
+		nextQuery++;
+		std::cout.flush();
+	});
+	printErrors(queries.size());
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+std::string entryName(const PasswordCatalog& catalog, size_t entry) {
+	std::string name(catalog.entryService(entry));
+	if (!catalog.isServiceFile(entry)) name.append(1, '/').append(catalog.username(entry));
+	return name;
+}
+
+// Reports reused and weak passwords, only the files changed since the last audit are decrypted
+int auditCommand() {
+	auto catalog = passwordStore.getEntries();
+	AuditCache cache;
+
+	bool failed = false;
+	std::vector<AuditCache::FileKey> fileKeys(catalog.entryCount()), liveFiles;
+	std::vector<std::optional<AuditRecord>> records(catalog.entryCount());
+	std::vector<FieldRequest> requests;
+	std::vector<size_t> requestEntry;
+	for (size_t i = 0; i < catalog.entryCount(); i++) {
+		// The entry can be removed after listing the store
+		try {
+			fileKeys[i] = AuditCache::fileKey(catalog.path(i));
+		} catch (const std::exception& e) {
+			std::cerr << entryName(catalog, i) << ": " << e.what() << '\n';
+			failed = true;
+			continue;
+		}
+		liveFiles.push_back(fileKeys[i]);
+		records[i] = cache.find(fileKeys[i]);
+		if (records[i]) continue;
+		requests.push_back({ catalog.path(i), "password", std::nullopt });
+		requestEntry.push_back(i);
+	}
+
+	passwordStore.decryptFields(requests, [&](size_t i, const FieldResult& result) {
+		size_t entry = requestEntry[i];
+		if (result.found) {
+			records[entry] = cache.add(fileKeys[entry], result.value);
+		} else {
+			std::cerr << entryName(catalog, entry) << ": " << result.value << '\n';
+			failed = true;
+		}
+	});
+	cache.save(liveFiles);
+
+	std::unordered_map<uint64_t, std::vector<size_t>> byFingerprint;
+	for (size_t i = 0; i < records.size(); i++)
+		if (records[i]) byFingerprint[records[i]->fingerprint].push_back(i);
+
+	std::cout << "Reused passwords:\n";
+	for (size_t i = 0; i < records.size(); i++) {
+		if (!records[i]) continue;
+		const auto& group = byFingerprint[records[i]->fingerprint];
+		if (group.size() < 2 || group[0] != i) continue;
+
+		std::cout << "  ";
+		for (size_t j = 0; j < group.size(); j++) std::cout << (j ? ", " : "") << entryName(catalog, group[j]);
+		std::cout << '\n';
+	}
+
+	std::cout << "Weak passwords:\n";
+	for (size_t i = 0; i < records.size(); i++)
+		if (records[i] && records[i]->strength < weakStrength)
+			std::cout << "  " << entryName(catalog, i) << " (" << records[i]->strength << " bits)\n";
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1) {
+		std::vector<std::string> args(argv + 2, argv + argc);
+		if (argv[1] == "get"sv) return getCommand(args);
+		if (argv[1] == "audit"sv && args.empty()) return auditCommand();
+		std::cerr << "Unknown command: " << argv[1] << '\n';
+		return EXIT_FAILURE;
+	}
+
+	auto catalog = passwordStore.getEntries();
 
-	auto serviceResult = askService(entries);
+	auto serviceResult = askService(catalog);
 	if (serviceResult.isEmpty()) return EXIT_SUCCESS;
-	if (serviceResult.isCommand()) return handleServiceCommand(serviceResult);
+	if (serviceResult.isCommand()) return handleServiceCommand(catalog, serviceResult);
 
-	if (serviceResult->size() == 1) {
-		copyInfo(serviceResult->at(0));
+	if (catalog.entryCount(*serviceResult) == 1) {
+		copyInfo(catalog, catalog.firstEntry(*serviceResult));
 		return EXIT_SUCCESS;
 	}
 
-	auto userResult = askUser(*serviceResult);
+	auto userResult = askUser(catalog, *serviceResult);
 	if (!userResult.isCommand()) {
-		copyInfo(*userResult);
+		copyInfo(catalog, *userResult);
 		return EXIT_SUCCESS;
 	}
 	if (userResult.isEmpty()) return EXIT_SUCCESS;
-	return handleUserCommand(serviceResult.value, userResult);
+	return handleUserCommand(catalog, serviceResult.value, userResult);
 }
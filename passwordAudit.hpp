@@ -0,0 +1,175 @@
+#pragma once
+
+#include "passwordPolicy.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+namespace detail {
+
+using SipKey = std::array<uint8_t, 16>;
+
+// SipHash-2-4, a keyed hash so the fingerprints can't be checked against a list of passwords without the key
+inline uint64_t sipHash(const SipKey& key, std::string_view data) {
+	const auto load64 = [](const uint8_t* p) {
+		uint64_t v = 0;
+		for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+		return v;
+	};
+	const auto rotl = [](uint64_t x, int b) { return (x << b) | (x >> (64 - b)); };
+
+	uint64_t k0 = load64(key.data()), k1 = load64(key.data() + 8);
+	uint64_t v0 = k0 ^ 0x736f6d6570736575, v1 = k1 ^ 0x646f72616e646f6d;
+	uint64_t v2 = k0 ^ 0x6c7967656e657261, v3 = k1 ^ 0x7465646279746573;
+
+	const auto round = [&] {
+		v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+		v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+		v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+		v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+	};
+	const auto compress = [&](uint64_t m) {
+		v3 ^= m;
+		round(); round();
+		v0 ^= m;
+	};
+
+	const uint8_t* in = (const uint8_t*)data.data();
+	size_t blocks = data.size() / 8;
+	for (size_t i = 0; i < blocks; i++) compress(load64(in + i * 8));
+
+	uint64_t last = (uint64_t)data.size() << 56;
+	for (size_t i = 0; i < data.size() % 8; i++) last |= (uint64_t)in[blocks * 8 + i] << (i * 8);
+	compress(last);
+
+	v2 ^= 0xff;
+	round(); round(); round(); round();
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+}
+
+struct AuditRecord {
+	uint64_t fingerprint;
+	int strength;
+};
+
+// Records of the already audited files, a file is audited again only when its inode or mtime changes.
+// The cache and its key are kept in $XDG_CACHE_HOME/dmenupass, readable only by the user
+class AuditCache {
+	// Records written with a different strength model are not reused
+	static constexpr std::string_view header = "dmenupass audit 2";
+public:
+	struct FileKey {
+		uint64_t device, inode;
+		int64_t mtime;
+		bool operator==(const FileKey& other) const { return device == other.device && inode == other.inode && mtime == other.mtime; }
+	};
+private:
+	struct FileKeyHash {
+		size_t operator()(const FileKey& key) const {
+			return std::hash<uint64_t>{}(key.inode) ^ (std::hash<int64_t>{}(key.mtime) * 31) ^ (std::hash<uint64_t>{}(key.device) * 131);
+		}
+	};
+
+	fs::path cacheDir;
+	detail::SipKey key;
+	std::unordered_map<FileKey, AuditRecord, FileKeyHash> records;
+
+	fs::path getCacheDir() {
+		char* env = getenv("XDG_CACHE_HOME");
+		if (env && *env) return fs::path(env) / "dmenupass";
+		if ((env = getenv("HOME"))) return fs::path(env) / ".cache" / "dmenupass";
+		throw std::runtime_error("Couldn't find cache path");
+	}
+
+	void writePrivate(const fs::path& path, std::string_view content) {
+		fs::path tmpPath = fs::path(path).concat(".tmp");
+		int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+		if (fd < 0) throw std::runtime_error("Couldn't write " + tmpPath.native() + ": " + strerror(errno));
+		ssize_t written = ::write(fd, content.data(), content.size());
+		::close(fd);
+		if (written != (ssize_t)content.size()) throw std::runtime_error("Couldn't write " + tmpPath.native());
+		fs::rename(tmpPath, path);
+	}
+
+	void loadKey() {
+		fs::path keyPath = cacheDir / "audit.key";
+		std::ifstream file(keyPath, std::ios::binary);
+		if (file.read((char*)key.data(), key.size())) return;
+
+		// Without the old key the old fingerprints are useless
+		records.clear();
+		std::random_device random;
+		for (auto& byte : key) byte = random();
+		writePrivate(keyPath, std::string_view((const char*)key.data(), key.size()));
+	}
+
+	void loadRecords() {
+		std::ifstream file(cacheDir / "audit");
+		std::string firstLine;
+		if (!std::getline(file, firstLine) || firstLine != header) return;
+		FileKey fileKey;
+		AuditRecord record;
+		while (file >> fileKey.device >> fileKey.inode >> fileKey.mtime >> std::hex >> record.fingerprint >> std::dec >> record.strength)
+			records[fileKey] = record;
+	}
+public:
+	AuditCache() : cacheDir(getCacheDir()) {
+		fs::create_directories(cacheDir);
+		fs::permissions(cacheDir, fs::perms::owner_all);
+		loadRecords();
+		loadKey();
+	}
+
+	static FileKey fileKey(const fs::path& path) {
+		struct stat info;
+		if (::stat(path.c_str(), &info) != 0) throw std::runtime_error("Couldn't stat " + path.native() + ": " + strerror(errno));
+		return { (uint64_t)info.st_dev, (uint64_t)info.st_ino, (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec };
+	}
+
+	std::optional<AuditRecord> find(const FileKey& fileKey) const {
+		auto recordIt = records.find(fileKey);
+		if (recordIt == end(records)) return std::nullopt;
+		return recordIt->second;
+	}
+
+	AuditRecord add(const FileKey& fileKey, std::string_view password) {
+		AuditRecord record = { detail::sipHash(key, password), passwordStrength(password) };
+		records[fileKey] = record;
+		return record;
+	}
+
+	// Only the records of the files still in the store are kept
+	void save(const std::vector<FileKey>& liveFiles) {
+		std::string content(header);
+		content += '\n';
+		char line[128];
+		for (const auto& fileKey : liveFiles) {
+			auto record = find(fileKey);
+			if (!record) continue;
+			int length = snprintf(line, sizeof line, "%llu %llu %lld %016llx %d\n",
+				(unsigned long long)fileKey.device, (unsigned long long)fileKey.inode, (long long)fileKey.mtime,
+				(unsigned long long)record->fingerprint, record->strength);
+			content.append(line, length);
+		}
+		writePrivate(cacheDir / "audit", content);
+	}
+};
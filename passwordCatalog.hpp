@@ -0,0 +1,142 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace detail {
+
+// Open addressing table of indices, the keys are not stored but the hashes are computed from the index
+class FlatIndex {
+	static constexpr uint32_t empty = UINT32_MAX;
+	std::vector<uint32_t> slots;
+	size_t mask = 0;
+public:
+	template<typename HashFn>
+	void build(size_t count, HashFn hashOf) {
+		size_t capacity = 8;
+		while (capacity < count * 2) capacity *= 2;
+		slots.assign(capacity, empty);
+		mask = capacity - 1;
+
+		for (uint32_t i = 0; i < count; i++) {
+			size_t pos = hashOf(i) & mask;
+			while (slots[pos] != empty) pos = (pos + 1) & mask;
+			slots[pos] = i;
+		}
+	}
+
+	template<typename MatchFn>
+	std::optional<uint32_t> find(size_t hash, MatchFn matches) const {
+		if (slots.empty()) return std::nullopt;
+		for (size_t pos = hash & mask; slots[pos] != empty; pos = (pos + 1) & mask)
+			if (matches(slots[pos])) return slots[pos];
+		return std::nullopt;
+	}
+};
+
+}
+
+// All the names are interned in a single arena, each service name is stored once and each entry
+// only stores its username (empty for a service file), services are contiguous ranges of entries
+class PasswordCatalog {
+	struct Entry {
+		uint32_t offset, service;
+		uint16_t usernameLength;
+	};
+	struct Service {
+		uint32_t offset, firstEntry, entryCount;
+		uint16_t nameLength;
+	};
+
+	fs::path storePath;
+	std::string arena;
+	std::vector<Entry> entries;
+	std::vector<Service> services;
+	detail::FlatIndex serviceIndex, entryIndex;
+
+	static size_t nameHash(std::string_view name) { return std::hash<std::string_view>{}(name); }
+	static size_t entryHash(size_t service, std::string_view username) {
+		return nameHash(username) ^ (service * 0x9e3779b97f4a7c15);
+	}
+public:
+	PasswordCatalog(fs::path storePath) : storePath(std::move(storePath)) {}
+
+	void beginService(std::string_view name) {
+		if (name.size() > UINT16_MAX) throw std::length_error("Service name too long");
+		services.push_back({ (uint32_t)arena.size(), (uint32_t)entries.size(), 0, (uint16_t)name.size() });
+		arena.append(name);
+	}
+	void addEntry(std::string_view username) {
+		if (username.size() > UINT16_MAX) throw std::length_error("Username too long");
+		entries.push_back({ (uint32_t)arena.size(), (uint32_t)services.size() - 1, (uint16_t)username.size() });
+		arena.append(username);
+		services.back().entryCount++;
+	}
+	void endService() {
+		if (services.back().entryCount > 0) return;
+		arena.resize(services.back().offset);
+		services.pop_back();
+	}
+	// Must be called once all the entries are added
+	void buildIndex() {
+		arena.shrink_to_fit();
+		entries.shrink_to_fit();
+		services.shrink_to_fit();
+		serviceIndex.build(services.size(), [this](uint32_t i){ return nameHash(serviceName(i)); });
+		entryIndex.build(entries.size(), [this](uint32_t i){ return entryHash(entries[i].service, username(i)); });
+	}
+
+	size_t serviceCount() const { return services.size(); }
+	size_t entryCount() const { return entries.size(); }
+
+	std::string_view serviceName(size_t service) const {
+		return std::string_view(arena).substr(services[service].offset, services[service].nameLength);
+	}
+	std::string_view username(size_t entry) const {
+		return std::string_view(arena).substr(entries[entry].offset, entries[entry].usernameLength);
+	}
+	std::string_view entryService(size_t entry) const { return serviceName(entries[entry].service); }
+	// A service file is a service stored as a single file, its username is inside the file
+	bool isServiceFile(size_t entry) const { return entries[entry].usernameLength == 0; }
+
+	size_t firstEntry(size_t service) const { return services[service].firstEntry; }
+	size_t entryCount(size_t service) const { return services[service].entryCount; }
+
+	fs::path path(size_t entry) const {
+		if (isServiceFile(entry)) return storePath / (std::string(entryService(entry)) + ".gpg");
+		return storePath / entryService(entry) / (std::string(username(entry)) + ".gpg");
+	}
+
+	std::vector<std::string_view> serviceNames() const {
+		std::vector<std::string_view> names;
+		names.reserve(services.size());
+		for (size_t i = 0; i < services.size(); i++) names.push_back(serviceName(i));
+		return names;
+	}
+	std::vector<std::string_view> usernames(size_t service) const {
+		std::vector<std::string_view> names;
+		names.reserve(entryCount(service));
+		for (size_t i = firstEntry(service); i < firstEntry(service) + entryCount(service); i++) names.push_back(username(i));
+		return names;
+	}
+
+	std::optional<uint32_t> findService(std::string_view name) const {
+		return serviceIndex.find(nameHash(name), [&](uint32_t i){ return serviceName(i) == name; });
+	}
+	std::optional<uint32_t> findEntry(size_t service, std::string_view username) const {
+		return entryIndex.find(entryHash(service, username), [&](uint32_t i){ return entries[i].service == service && this->username(i) == username; });
+	}
+	std::optional<uint32_t> findEntry(std::string_view service, std::string_view username) const {
+		auto serviceIdx = findService(service);
+		if (!serviceIdx) return std::nullopt;
+		return findEntry(*serviceIdx, username);
+	}
+};
@@ -0,0 +1,394 @@
+#pragma once
+
+#include "wordlist.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_map>
+#include <initializer_list>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+namespace detail {
+
+class CharSet {
+	std::array<uint64_t, 2> bits {};
+
+	constexpr void add(int c) {
+		if (c < 0 || c >= 128) throw std::invalid_argument("Only ASCII characters are supported");
+		bits[c / 64] |= uint64_t(1) << (c % 64);
+	}
+public:
+	constexpr CharSet() = default;
+	// "a-z" is a range, any other character is itself
+	constexpr CharSet(std::string_view str) {
+		for (size_t i = 0; i < str.length(); i++) {
+			if (i + 2 < str.length() && str[i + 1] == '-') {
+				if (str[i] > str[i + 2]) throw std::invalid_argument("Begin of range bigger than end");
+				for (int c = str[i]; c <= str[i + 2]; c++) add(c);
+				i += 2;
+			} else
+				add(str[i]);
+		}
+	}
+
+	constexpr bool contains(char c) const {
+		unsigned char uc = c;
+		return uc < 128 && (bits[uc / 64] >> (uc % 64) & 1);
+	}
+	constexpr int size() const {
+		int n = 0;
+		for (int c = 0; c < 128; c++) n += contains(c);
+		return n;
+	}
+	constexpr char operator[](int n) const {
+		for (int c = 0; c < 128; c++)
+			if (contains(c) && n-- == 0) return c;
+		throw std::invalid_argument("Out of bounds");
+	}
+
+	constexpr CharSet operator|(const CharSet& other) const {
+		CharSet out;
+		out.bits = { bits[0] | other.bits[0], bits[1] | other.bits[1] };
+		return out;
+	}
+	constexpr CharSet without(const CharSet& other) const {
+		CharSet out;
+		out.bits = { bits[0] & ~other.bits[0], bits[1] & ~other.bits[1] };
+		return out;
+	}
+
+	template<typename T>
+	char pick(T& rng) const {
+		std::uniform_int_distribution<int> distribution(0, size() - 1);
+		return operator[](distribution(rng));
+	}
+};
+
+// Lower bound of the bits of entropy of a password with a character from each class and the rest
+// from the pool, the positions of the required characters are not counted
+inline double requiredClassesEntropy(int length, const CharSet* classes, int classCount, int poolSize) {
+	if (poolSize <= 1) return 0;
+	double bits = (length - classCount) * std::log2(poolSize);
+	for (int i = 0; i < classCount; i++) bits += std::log2(classes[i].size());
+	return bits;
+}
+
+}
+
+constexpr static std::string_view lowercaseClass = "a-z", uppercaseClass = "A-Z", digitClass = "0-9", symbolClass = "!-/:-@[-`{-~";
+// Used to estimate the strength of any password
+constexpr static std::array<detail::CharSet, 4> characterClasses = {
+	detail::CharSet(lowercaseClass), detail::CharSet(uppercaseClass), detail::CharSet(digitClass), detail::CharSet(symbolClass)
+};
+
+// A password has at least one character from each required class, this is done when generating
+// by placing one character of each class and shuffling, so there is no need to retry.
+// Policies built in a constexpr context are validated at compile time
+class PasswordPolicy {
+public:
+	static constexpr int maxClasses = 8;
+private:
+	std::string_view policyName;
+	std::array<detail::CharSet, maxClasses> required {};
+	int requiredCount = 0;
+	detail::CharSet banned, allowed;
+	int passwordLength = 0, maxLength = 0;
+
+	constexpr void update() {
+		allowed = {};
+		for (int i = 0; i < requiredCount; i++) {
+			required[i] = required[i].without(banned);
+			if (required[i].size() == 0) throw std::invalid_argument("Required class has only banned characters");
+			allowed = allowed | required[i];
+		}
+		if (requiredCount == 0) throw std::invalid_argument("No character classes");
+		if (maxLength > 0 && passwordLength > maxLength) passwordLength = maxLength;
+		if (passwordLength < requiredCount) throw std::invalid_argument("Length too short for the required classes");
+	}
+public:
+	// maxLength is 0 when there is no maximum
+	constexpr PasswordPolicy(std::string_view name, std::initializer_list<std::string_view> classes, int length, int maxLength = 0, std::string_view bannedChars = "") :
+		policyName(name), banned(bannedChars), passwordLength(length), maxLength(maxLength)
+	{
+		if (classes.size() > maxClasses) throw std::invalid_argument("Too many character classes");
+		for (auto cls : classes) required[requiredCount++] = detail::CharSet(cls);
+		update();
+	}
+
+	constexpr std::string_view name() const { return policyName; }
+	constexpr int length() const { return passwordLength; }
+
+	constexpr PasswordPolicy withLength(int length) const {
+		PasswordPolicy out = *this;
+		out.passwordLength = length;
+		out.update();
+		return out;
+	}
+	// The length is reduced to fit the maximum
+	constexpr PasswordPolicy withMaxLength(int maxLength) const {
+		PasswordPolicy out = *this;
+		out.maxLength = maxLength;
+		out.update();
+		return out;
+	}
+	constexpr PasswordPolicy withBanned(std::string_view bannedChars) const {
+		PasswordPolicy out = *this;
+		out.banned = out.banned | detail::CharSet(bannedChars);
+		out.update();
+		return out;
+	}
+	template<typename Container>
+	PasswordPolicy withRequired(const Container& classes) const {
+		if (classes.size() > maxClasses) throw std::invalid_argument("Too many character classes");
+		PasswordPolicy out = *this;
+		out.requiredCount = 0;
+		for (const auto& cls : classes) out.required[out.requiredCount++] = detail::CharSet(cls);
+		out.update();
+		return out;
+	}
+
+	double entropy() const {
+		return detail::requiredClassesEntropy(passwordLength, required.data(), requiredCount, allowed.size());
+	}
+
+	template<typename T>
+	std::string operator()(T& rng) const {
+		std::string out;
+		out.reserve(passwordLength);
+		for (int i = 0; i < requiredCount; i++) out += required[i].pick(rng);
+		while ((int)out.size() < passwordLength) out += allowed.pick(rng);
+		std::shuffle(begin(out), end(out), rng);
+		return out;
+	}
+};
+
+// Strength of any password, as if it was generated by a policy requiring the classes it uses.
+// Characters outside of the classes only make the pool bigger
+inline int passwordStrength(std::string_view password) {
+	std::vector<detail::CharSet> used;
+	bool usesOther = false;
+	for (char c : password) {
+		auto classIt = std::find_if(begin(characterClasses), end(characterClasses), [c](const auto& cls){ return cls.contains(c); });
+		if (classIt == end(characterClasses)) usesOther = true;
+		else if (std::find_if(begin(used), end(used), [c](const auto& cls){ return cls.contains(c); }) == end(used)) used.push_back(*classIt);
+	}
+
+	int poolSize = usesOther ? 128 : 0;
+	for (const auto& cls : used) poolSize += cls.size();
+	return (int)detail::requiredClassesEntropy(password.size(), used.data(), used.size(), poolSize);
+}
+
+// Words for diceware passphrases, the words point inside the text of the list,
+// either the built in one or a file mapped in memory. Only words of 3 to 9 lowercase letters are used,
+// each on its own line and optionally after a column of dice rolls
+class Wordlist {
+	void* data = MAP_FAILED;
+	size_t dataSize = 0;
+	std::vector<std::string_view> words;
+
+	void parse(std::string_view text, const std::string& name) {
+		while (!text.empty()) {
+			size_t newlinePos = text.find('\n');
+			std::string_view word = text.substr(0, newlinePos);
+			text.remove_prefix(newlinePos == std::string_view::npos ? text.size() : newlinePos + 1);
+
+			// Lines of the diceware and EFF lists start with the dice rolls, "11111\tword"
+			if (!word.empty() && word.back() == '\r') word.remove_suffix(1);
+			size_t wordPos = word.find_first_not_of("0123456789");
+			if (wordPos > 0 && wordPos != std::string_view::npos && isspace(word[wordPos]))
+				word = word.substr(std::min(word.find_first_not_of(" \t", wordPos), word.size()));
+
+			if (word.size() < 3 || word.size() > 9) continue;
+			if (std::all_of(begin(word), end(word), [](char c){ return c >= 'a' && c <= 'z'; })) words.push_back(word);
+		}
+		std::sort(begin(words), end(words));
+		words.erase(std::unique(begin(words), end(words)), end(words));
+		if (words.size() < 2) throw std::runtime_error("Not enough words in " + name);
+	}
+public:
+	Wordlist() { parse(builtinWordlist, "the built in wordlist"); }
+	Wordlist(const fs::path& path) {
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) throw std::runtime_error("Couldn't open wordlist " + path.native());
+
+		struct stat info;
+		if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+			dataSize = info.st_size;
+			data = ::mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		::close(fd);
+		if (data == MAP_FAILED) throw std::runtime_error("Couldn't map wordlist " + path.native());
+
+		try {
+			parse(std::string_view((const char*)data, dataSize), path.native());
+		} catch (...) {
+			::munmap(data, dataSize);
+			throw;
+		}
+	}
+	~Wordlist() { if (data != MAP_FAILED) ::munmap(data, dataSize); }
+
+	Wordlist(const Wordlist&) = delete;
+	Wordlist& operator=(const Wordlist&) = delete;
+
+	size_t size() const { return words.size(); }
+	const std::vector<std::string_view>& all() const { return words; }
+};
+
+// Diceware passphrase that meets a maximum length and banned characters, only the words short enough
+// and without banned characters are drawn so the entropy is still exact
+class Passphrase {
+	std::vector<std::string_view> pool;
+	int wordCount;
+	std::string separator;
+public:
+	// maxLength is 0 when there is no maximum
+	Passphrase(const Wordlist& wordlist, int wordCount, std::string separator, int maxLength = 0, std::string_view bannedChars = "") :
+		wordCount(wordCount), separator(std::move(separator))
+	{
+		if (wordCount <= 0) throw std::invalid_argument("Invalid number of words");
+		detail::CharSet banned(bannedChars);
+		if (std::any_of(begin(this->separator), end(this->separator), [&](char c){ return banned.contains(c); }))
+			throw std::invalid_argument("Separator has banned characters");
+
+		size_t maxWordLength = SIZE_MAX;
+		if (maxLength > 0) {
+			int available = maxLength - (wordCount - 1) * (int)this->separator.size();
+			maxWordLength = available > 0 ? available / wordCount : 0;
+		}
+		for (auto word : wordlist.all())
+			if (word.size() <= maxWordLength && std::none_of(begin(word), end(word), [&](char c){ return banned.contains(c); }))
+				pool.push_back(word);
+		if (pool.size() < 2) throw std::invalid_argument("Not enough words for the maximum length and banned characters");
+	}
+
+	double entropy() const { return wordCount * std::log2(pool.size()); }
+
+	template<typename T>
+	std::string operator()(T& rng) const {
+		std::uniform_int_distribution<size_t> distribution(0, pool.size() - 1);
+		std::string out;
+		for (int i = 0; i < wordCount; i++) {
+			if (i) out.append(separator);
+			out.append(pool[distribution(rng)]);
+		}
+		return out;
+	}
+};
+
+// Overrides of a single service, empty values keep the ones of the policy
+struct ServiceRule {
+	std::string policy, banned, wordlist;
+	std::vector<std::string> required;
+	int length = 0, maxLength = 0;
+	int dicewareWords = 0;
+	std::string separator = "-";
+
+	PasswordPolicy apply(PasswordPolicy base) const {
+		if (!required.empty()) base = base.withRequired(required);
+		if (!banned.empty()) base = base.withBanned(banned);
+		if (length > 0) base = base.withLength(length);
+		if (maxLength > 0) base = base.withMaxLength(maxLength);
+		return base;
+	}
+	Passphrase passphrase(const Wordlist& wordlist) const {
+		return Passphrase(wordlist, dicewareWords, separator, maxLength, banned);
+	}
+
+	// Catches the diceware rules that can't be met with any wordlist, the words have at least 3 letters
+	void validate() const {
+		if (dicewareWords <= 0) return;
+		detail::CharSet bannedSet(banned);
+		if (std::any_of(begin(separator), end(separator), [&](char c){ return bannedSet.contains(c); }))
+			throw std::invalid_argument("Separator has banned characters");
+		if (detail::CharSet(lowercaseClass).without(bannedSet).size() == 0) throw std::invalid_argument("Diceware words have only banned characters");
+		if (maxLength > 0 && dicewareWords * 3 + (dicewareWords - 1) * (int)separator.size() > maxLength)
+			throw std::invalid_argument("Diceware words don't fit the maximum length");
+	}
+};
+
+// Per service rules, read from an ini like file:
+//   [service]
+//   policy = name of the policy to use
+//   length = 16
+//   max = 20
+//   require = a-z (can be repeated, replaces the classes of the policy)
+//   ban = characters that can't be used
+//   diceware = number of words, only passphrases are suggested, they also meet max and ban
+//   separator = -
+//   wordlist = path of the wordlist
+class PolicyRules {
+	std::unordered_map<std::string, ServiceRule> rules;
+
+	static std::string trimmed(const std::string& str) {
+		auto beg = std::find_if_not(begin(str), end(str), isspace);
+		auto end = std::find_if_not(str.rbegin(), str.rend(), isspace).base();
+		return beg < end ? std::string(beg, end) : std::string();
+	}
+public:
+	// A missing file means no rules
+	PolicyRules(const fs::path& path) {
+		std::ifstream file(path);
+		std::string line;
+		ServiceRule* rule = nullptr;
+		for (int lineNumber = 1; std::getline(file, line); lineNumber++) {
+			line = trimmed(line);
+			if (line.empty() || line[0] == '#') continue;
+
+			const auto error = [&](const std::string& what) {
+				return std::runtime_error(path.native() + ":" + std::to_string(lineNumber) + ": " + what);
+			};
+
+			if (line.front() == '[' && line.back() == ']') {
+				rule = &rules[trimmed(line.substr(1, line.size() - 2))];
+				continue;
+			}
+
+			size_t equalPos = line.find('=');
+			if (!rule || equalPos == std::string::npos) throw error("Expected [service] or key = value");
+			std::string key = trimmed(line.substr(0, equalPos)), value = trimmed(line.substr(equalPos + 1));
+
+			try {
+				if (key == "policy") rule->policy = value;
+				else if (key == "length") rule->length = std::stoi(value);
+				else if (key == "max") rule->maxLength = std::stoi(value);
+				else if (key == "require") rule->required.push_back(value);
+				else if (key == "ban") rule->banned += value;
+				else if (key == "diceware") rule->dicewareWords = std::stoi(value);
+				else if (key == "separator") rule->separator = value;
+				else if (key == "wordlist") rule->wordlist = value;
+				else throw error("Unknown key " + key);
+			} catch (const std::logic_error&) {
+				throw error("Invalid value for " + key);
+			}
+		}
+
+		for (const auto& [ service, rule ] : rules) {
+			try {
+				rule.validate();
+			} catch (const std::invalid_argument& e) {
+				throw std::runtime_error(path.native() + ": [" + service + "]: " + e.what());
+			}
+		}
+	}
+
+	const ServiceRule* find(const std::string& service) const {
+		auto ruleIt = rules.find(service);
+		return ruleIt == end(rules) ? nullptr : &ruleIt->second;
+	}
+};
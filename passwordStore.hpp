@@ -4,13 +4,27 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <map>
+#include <deque>
+#include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
 #include <filesystem>
 #include <iostream>
-
+#include <functional>
+#include <string_view>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
 #include <gpgme.h>
 #include "notifications.hpp"
+#include "passwordCatalog.hpp"
 
 using namespace std::placeholders;
 namespace fs = std::filesystem;
@@ -22,79 +36,199 @@ struct PasswordEntry {
 	PasswordEntry(fs::path path) : path(path), service(path.stem()) {}
 	PasswordEntry(fs::path path, std::string service) : path(path), service(service), username(path.stem()) {}
 	PasswordEntry(std::string service, std::string username, std::string password) : service(service), username(username), password(password) {}
+	PasswordEntry(const PasswordCatalog& catalog, size_t entry) :
+		path(catalog.path(entry)),
+		service(catalog.entryService(entry)),
+		username(catalog.username(entry))
+	{}
+
+};
+
+// The field is "password" for the first line, otherwise the value of the first "field:" line.
+// The fallback is used when the file has no such line
+struct FieldRequest {
+	fs::path path;
+	std::string field;
+	std::optional<std::string> fallback;
+};
 
+struct FieldResult {
+	bool found = false;
+	// The error message when not found
+	std::string value;
 };
 
 class PasswordStore {
+	static constexpr size_t maxDecryptThreads = 8;
+
 	class GpgmeHandler {
 		gpgme_ctx_t ctx;
-		gpgme_key_t key;
+
+		// All the usable keys are listed once, the recipients are resolved from the aliases of the keys,
+		// or like gpg from a case insensitive substring of a user id
+		bool keysListed = false;
+		std::unordered_map<std::string, gpgme_key_t> keys;
+		std::unordered_map<std::string, std::string> keyAliases;
+		std::vector<std::pair<std::string, std::string>> keyUids;
 
 		inline void check(gpgme_error_t error) {
 			if (!error) return;
 			std::string text = std::string(gpgme_strsource(error)) + ": " + gpgme_strerror(error) + '\n';
 			throw std::runtime_error(text.c_str());
 		}
-	public:
-		GpgmeHandler(std::string gpgId) {
-			gpgme_check_version(nullptr);
-			check(gpgme_engine_check_version(GPGME_PROTOCOL_OPENPGP));
 
-			check(gpgme_new(&ctx));
-			check(gpgme_ctx_set_engine_info(ctx, GPGME_PROTOCOL_OPENPGP, "/usr/bin/gpg", nullptr));
+		static std::string lowercase(std::string str) {
+			std::transform(begin(str), end(str), begin(str), tolower);
+			return str;
+		}
 
+		static std::string normalizeId(std::string id) {
+			if (!id.empty() && id.back() == '!') id.pop_back();
+			if (id.size() > 2 && id.front() == '<' && id.back() == '>') id = id.substr(1, id.size() - 2);
+			if (id.find('@') != std::string::npos) return lowercase(id);
+			if (id.compare(0, 2, "0x") == 0 || id.compare(0, 2, "0X") == 0) id.erase(0, 2);
+			std::transform(begin(id), end(id), begin(id), toupper);
+			return id;
+		}
+
+		void listKeys() {
+			if (keysListed) return;
+			keysListed = true;
+
+			gpgme_key_t key;
 			check(gpgme_op_keylist_start(ctx, nullptr, 0));
 			for (;;) {
 				gpgme_error_t ret = gpgme_op_keylist_next(ctx, &key);
-				if (gpg_err_code(ret) == GPG_ERR_EOF) throw std::runtime_error("Couldn't find the key");
+				if (gpg_err_code(ret) == GPG_ERR_EOF) break;
 				check(ret);
 
-				// FIXME: probably this is wrong the gpgId could be something different than the email
-				if (gpgId == key->uids->email) break;
-
-				gpgme_key_release(key);
+				if (!key->can_encrypt || !key->fpr || keys.count(key->fpr)) {
+					gpgme_key_release(key);
+					continue;
+				}
+				keys.emplace(key->fpr, key);
+				for (gpgme_subkey_t subkey = key->subkeys; subkey; subkey = subkey->next) {
+					if (subkey->fpr) keyAliases.emplace(normalizeId(subkey->fpr), key->fpr);
+					if (subkey->keyid) {
+						std::string keyid = normalizeId(subkey->keyid);
+						keyAliases.emplace(keyid, key->fpr);
+						if (keyid.size() > 8) keyAliases.emplace(keyid.substr(keyid.size() - 8), key->fpr);
+					}
+				}
+				for (gpgme_user_id_t uid = key->uids; uid; uid = uid->next) {
+					if (uid->email) keyAliases.emplace(normalizeId(uid->email), key->fpr);
+					if (uid->uid) keyUids.emplace_back(lowercase(uid->uid), key->fpr);
+				}
 			}
 		}
-		~GpgmeHandler() { gpgme_release(ctx); }
-
-		void encrypt(std::string content, fs::path path) {
-			gpgme_data_t plain, chiper;
-			gpgme_key_t keys[2] = { key, nullptr };
 
-			check(gpgme_data_new_from_mem(&plain, content.c_str(), content.size(), 0));
-			check(gpgme_data_new(&chiper));
+		using Sink = std::function<void(std::string_view)>;
 
-			const auto flags = (gpgme_encrypt_flags_t)(GPGME_ENCRYPT_NO_ENCRYPT_TO | GPGME_ENCRYPT_NO_COMPRESS);
-			check(gpgme_op_encrypt(ctx, keys, flags, plain, chiper));
-
-			gpgme_data_release(plain);
+		// gpgme calls this with each decrypted chunk, the chunk is only valid during the call
+		static ssize_t sinkWrite(void* handle, const void* buffer, size_t size) {
+			try {
+				(*(Sink*)handle)(std::string_view((const char*)buffer, size));
+				return size;
+			} catch (...) {
+				errno = EIO;
+				return -1;
+			}
+		}
 
-			size_t length;
-			char* chiperData = gpgme_data_release_and_get_mem(chiper, &length);
+		int openFile(const fs::path& path, int flags, mode_t mode = 0666) {
+			int fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+			if (fd < 0) throw std::runtime_error("Couldn't open " + path.native() + ": " + strerror(errno));
+			return fd;
+		}
 
-			std::ofstream file(path);
-			file.write(chiperData, length);
+		// Takes ownership of plain
+		void decrypt(fs::path path, gpgme_data_t plain) {
+			gpgme_data_t chiper;
+			int fd;
+			try {
+				fd = openFile(path, O_RDONLY);
+			} catch (...) {
+				gpgme_data_release(plain);
+				throw;
+			}
 
-			gpgme_free(chiperData);
+			gpgme_error_t error = gpgme_data_new_from_fd(&chiper, fd);
+			if (!error) {
+				error = gpgme_op_decrypt(ctx, chiper, plain);
+				gpgme_data_release(chiper);
+			}
+			::close(fd);
+			gpgme_data_release(plain);
+			check(error);
 		}
+	public:
+		GpgmeHandler() {
+			gpgme_check_version(nullptr);
+			check(gpgme_engine_check_version(GPGME_PROTOCOL_OPENPGP));
 
-		std::string decrypt(fs::path path) {
-			gpgme_data_t chiper, plain;
-			check(gpgme_data_new_from_file(&chiper, path.c_str(), 1));
-			check(gpgme_data_new(&plain));
+			check(gpgme_new(&ctx));
+			check(gpgme_ctx_set_engine_info(ctx, GPGME_PROTOCOL_OPENPGP, "/usr/bin/gpg", nullptr));
+		}
+		~GpgmeHandler() {
+			for (auto& [ fpr, key ] : keys) gpgme_key_release(key);
+			gpgme_release(ctx);
+		}
 
-			check(gpgme_op_decrypt(ctx, chiper, plain));
+		gpgme_key_t findKey(const std::string& gpgId) {
+			listKeys();
+			auto aliasIt = keyAliases.find(normalizeId(gpgId));
+			if (aliasIt != end(keyAliases)) return keys.at(aliasIt->second);
 
-			gpgme_data_release(chiper);
+			std::string needle = lowercase(gpgId);
+			auto uidIt = std::find_if(begin(keyUids), end(keyUids), [&](const auto& uid){ return uid.first.find(needle) != std::string::npos; });
+			if (uidIt == end(keyUids)) throw std::runtime_error("Couldn't find the key for " + gpgId);
+			return keys.at(uidIt->second);
+		}
 
-			size_t length;
-			char* plainData = gpgme_data_release_and_get_mem(plain, &length);
+		void encrypt(const std::string& content, fs::path path, const std::vector<gpgme_key_t>& recipients) {
+			gpgme_data_t plain, chiper;
+			std::vector<gpgme_key_t> keyList(recipients);
+			keyList.push_back(nullptr);
+
+			// The ciphertext goes to a temporary file that replaces the entry only on success,
+			// so a failed encryption never leaves the entry empty or half written
+			fs::path tmpPath = fs::path(path).concat(".tmp");
+			int fd = openFile(tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+			gpgme_error_t error = gpgme_data_new_from_mem(&plain, content.c_str(), content.size(), 0);
+			if (!error) {
+				error = gpgme_data_new_from_fd(&chiper, fd);
+				if (!error) {
+					const auto flags = (gpgme_encrypt_flags_t)(GPGME_ENCRYPT_NO_ENCRYPT_TO | GPGME_ENCRYPT_NO_COMPRESS);
+					error = gpgme_op_encrypt(ctx, keyList.data(), flags, plain, chiper);
+					gpgme_data_release(chiper);
+				}
+				gpgme_data_release(plain);
+			}
 
-			std::string tmp(plainData, length);
+			bool written = !error && ::fsync(fd) == 0;
+			written = ::close(fd) == 0 && written;
+			if (!written) {
+				int writeError = errno;
+				::unlink(tmpPath.c_str());
+				check(error);
+				throw std::runtime_error("Couldn't write " + tmpPath.native() + ": " + strerror(writeError));
+			}
+			fs::rename(tmpPath, path);
+		}
 
-			gpgme_free(plainData);
+		// Writes the plaintext to fd as it is decrypted
+		void decrypt(fs::path path, int fd) {
+			gpgme_data_t plain;
+			check(gpgme_data_new_from_fd(&plain, fd));
+			decrypt(path, plain);
+		}
 
-			return tmp;
+		// Passes the plaintext to sink in chunks of bounded size as it is decrypted
+		void decrypt(fs::path path, Sink sink) {
+			static gpgme_data_cbs callbacks = { nullptr, sinkWrite, nullptr, nullptr };
+			gpgme_data_t plain;
+			check(gpgme_data_new_from_cbs(&plain, &callbacks, &sink));
+			decrypt(path, plain);
 		}
 	};
 
@@ -104,79 +238,231 @@ class PasswordStore {
 		if ((env = getenv("HOME"))) return fs::path(env) / ".password-store";
 		throw std::runtime_error("Couldn't find password store path");
 	}
-	std::string readContents(fs::path path) {
+	// Same format used by pass, one id per line with '#' comments, an id can contain spaces ("John Doe <john@example.com>")
+	std::vector<std::string> readGpgIds(fs::path path) {
 		std::ifstream file(path);
 		if (!file) throw std::runtime_error("Missing file");
 
-		file.seekg(0, std::ios::end);
-		// We don't read the last '\n'
-		// TODO: find a better way to handle this
-		size_t length = (size_t)file.tellg() - 1;
-		file.seekg(0, std::ios::beg);
+		std::vector<std::string> ids;
+		std::string line;
+		while (std::getline(file, line)) {
+			line.erase(std::min(line.find('#'), line.size()));
+			line.erase(std::find_if_not(line.rbegin(), line.rend(), isspace).base(), end(line));
+			line.erase(begin(line), std::find_if_not(begin(line), end(line), isspace));
+			if (!line.empty()) ids.push_back(std::move(line));
+		}
+		if (ids.empty()) throw std::runtime_error("No recipients in " + path.native());
+		return ids;
+	}
+
+	// Like pass the recipients are taken from the nearest .gpg-id going up to the store root
+	const std::vector<gpgme_key_t>& getRecipients(fs::path file) {
+		fs::path dir = file.parent_path();
+		for (;;) {
+			fs::path gpgIdPath = dir / ".gpg-id";
+			auto cached = recipients.find(gpgIdPath);
+			if (cached != end(recipients)) return cached->second;
+
+			if (fs::is_regular_file(gpgIdPath)) {
+				std::vector<gpgme_key_t> keys;
+				for (const auto& id : readGpgIds(gpgIdPath)) keys.push_back(gpgme.findKey(id));
+				return recipients.emplace(gpgIdPath, std::move(keys)).first->second;
+			}
+
+			auto relative = dir.lexically_relative(storePath);
+			if (relative.empty() || relative == "." || *relative.begin() == "..")
+				throw std::runtime_error("Couldn't find .gpg-id for " + file.native());
+			dir = dir.parent_path();
+		}
+	}
+
+	void encryptEntry(const std::string& content, fs::path path) {
+		gpgme.encrypt(content, path, getRecipients(path));
+	}
 
-		std::string buffer(length, 0);
-		file.read(buffer.data(), length);
+	static std::optional<std::string> fieldValue(const std::string& line, const std::string& field) {
+		const auto lowerTrimmed = [](std::string str) {
+			str.erase(begin(str), std::find_if_not(begin(str), end(str), isspace));
+			std::transform(begin(str), end(str), begin(str), tolower);
+			return str;
+		};
 
-		return buffer;
+		std::string tocmp = lowerTrimmed(line);
+		bool matches = tocmp.find(field + ":") == 0;
+		if (field == "username") matches = matches || tocmp.find("login:") == 0;
+		if (!matches) return std::nullopt;
+
+		auto valueBeg = begin(line) + line.find(":") + 1;
+		valueBeg = std::find_if_not(valueBeg, line.end(), isspace);
+		return std::string(valueBeg, end(line));
+	}
+
+	// Calls onLine for each line as the file is decrypted until it returns true,
+	// lines are cut to maxLineLength and then flagged as truncated
+	static void decryptLines(GpgmeHandler& handler, const fs::path& path, std::function<bool(const std::string&, bool)> onLine) {
+		const size_t maxLineLength = 4096;
+		bool firstLine = true, truncated = false, done = false;
+		std::string line;
+
+		handler.decrypt(path, [&](std::string_view chunk) {
+			while (!done) {
+				size_t newlinePos = chunk.find('\n');
+				std::string_view part = chunk.substr(0, newlinePos);
+				size_t room = maxLineLength - line.size();
+				if (part.size() > room) truncated = true;
+				line.append(part.substr(0, room));
+				if (newlinePos == std::string_view::npos) break;
+
+				done = onLine(line, truncated);
+				firstLine = truncated = false;
+				line.clear();
+				chunk.remove_prefix(newlinePos + 1);
+			}
+		});
+		if (!done && (firstLine || !line.empty())) onLine(line, truncated);
+	}
+
+	static std::optional<std::string> decryptField(GpgmeHandler& handler, const fs::path& path, std::string field) {
+		std::transform(begin(field), end(field), begin(field), tolower);
+
+		std::optional<std::string> value;
+		bool firstLine = true, truncated = false;
+		decryptLines(handler, path, [&](const std::string& line, bool lineTruncated) {
+			if (firstLine) {
+				firstLine = false;
+				if (field == "password") value = line;
+			} else
+				value = fieldValue(line, field);
+			truncated = value && lineTruncated;
+			return value.has_value();
+		});
+		if (truncated) throw std::runtime_error("The " + field + " line of " + path.native() + " is too long");
+		return value;
 	}
 
 	fs::path storePath;
 	GpgmeHandler gpgme;
+	std::map<fs::path, std::vector<gpgme_key_t>> recipients;
 public:
 
-	PasswordStore() : storePath(getStorePath()), gpgme(readContents(storePath/".gpg-id")) {}
+	PasswordStore() : storePath(getStorePath()) {}
 
-	std::vector<std::vector<PasswordEntry>> getEntries() {
-		std::vector<std::vector<PasswordEntry>> entries;
+	const fs::path& path() const { return storePath; }
 
-		auto usenameIterFunc = [](fs::path path){
-			std::vector<PasswordEntry> entries;
-			fs::directory_iterator folderIter(path);
-			std::string service = path.filename();
-			for (const auto& item : folderIter) {
-				if (!item.is_regular_file() || item.path().extension() != ".gpg") continue;
-				entries.emplace_back(item.path(), service);
-			}
-			return entries;
-		};
+	PasswordCatalog getEntries() {
+		PasswordCatalog catalog(storePath);
 
 		fs::directory_iterator folderIter(storePath);
 		for (const auto& item : folderIter) {
 			if (item.is_directory()) {
 				if (item.path().filename() == ".git") continue;
-				auto userEntries = usenameIterFunc(item.path());
-				if (userEntries.size() > 0) entries.emplace_back(std::move(userEntries));
+				catalog.beginService(item.path().filename().native());
+				for (const auto& userItem : fs::directory_iterator(item.path())) {
+					if (!userItem.is_regular_file() || userItem.path().extension() != ".gpg") continue;
+					catalog.addEntry(userItem.path().stem().native());
+				}
+				catalog.endService();
 			} else {
 				if (!item.is_regular_file() || item.path().extension() != ".gpg") continue;
-				entries.push_back(std::vector<PasswordEntry>{ item.path() });
+				catalog.beginService(item.path().stem().native());
+				catalog.addEntry({});
+				catalog.endService();
 			}
 		}
-		return entries;
+		catalog.buildIndex();
+		return catalog;
 	}
 
 	void decryptEntry(PasswordEntry& entry) {
-		const auto lowerTrimmed = [](std::string str) {
-			str.erase(begin(str), std::find_if_not(begin(str), end(str), isspace));
-			std::transform(begin(str), end(str), begin(str), tolower);
-			return str;
-		};
+		// Only the first line and the username are needed, the rest of the file is not stored
+		bool firstLine = true, truncated = false;
+		decryptLines(gpgme, entry.path, [&](const std::string& line, bool lineTruncated) {
+			if (firstLine) {
+				entry.password = line;
+				firstLine = false;
+				truncated = lineTruncated;
+				return false;
+			}
+			auto username = fieldValue(line, "username");
+			if (username) entry.username = *username;
+			truncated = truncated || (username && lineTruncated);
+			return username.has_value();
+		});
+		if (truncated) throw std::runtime_error("A line of " + entry.path.native() + " is too long");
+	}
+
+	// The requests are split between threads, each one with its own gpgme context since they can't be shared.
+	// onResult is called from the calling thread in the order of the requests, as soon as each one is ready
+	void decryptFields(const std::vector<FieldRequest>& requests, std::function<void(size_t, const FieldResult&)> onResult) {
+		std::vector<FieldResult> results(requests.size());
+		std::vector<bool> ready(requests.size());
+		std::mutex mutex;
+		std::condition_variable readyChanged;
+		size_t nextRequest = 0;
+
+		const auto worker = [&](GpgmeHandler& handler) {
+			for (;;) {
+				size_t i;
+				{
+					std::lock_guard lock(mutex);
+					if (nextRequest == requests.size()) return;
+					i = nextRequest++;
+				}
 
-		std::string line, infoStr = gpgme.decrypt(entry.path);
-		std::istringstream strStream(infoStr);
+				FieldResult result;
+				try {
+					auto value = decryptField(handler, requests[i].path, requests[i].field);
+					if (!value) value = requests[i].fallback;
+					if (value) result = { true, std::move(*value) };
+					else result = { false, "Missing field " + requests[i].field };
+				} catch (const std::exception& e) {
+					result = { false, e.what() };
+				}
 
-		std::getline(strStream, entry.password);
+				std::lock_guard lock(mutex);
+				results[i] = std::move(result);
+				ready[i] = true;
+				readyChanged.notify_one();
+			}
+		};
 
-		while (std::getline(strStream, line)) {
-			std::string tocmp = lowerTrimmed(line);
-			if (tocmp.find("username:") == 0 || tocmp.find("login:") == 0) {
-				auto usernameBeg = begin(line) + line.find(":") + 1;
-				usernameBeg = std::find_if_not(usernameBeg, line.end(), isspace);
-				entry.username = std::string(usernameBeg, end(line));
-				break;
+		size_t threadCount = std::min<size_t>({ std::max(std::thread::hardware_concurrency(), 1u), requests.size(), maxDecryptThreads });
+		std::deque<GpgmeHandler> handlers;
+		std::vector<std::thread> threads;
+
+		// If starting a thread or onResult throws the remaining requests are dropped,
+		// the threads must be joined before the state they reference goes away
+		struct Joiner {
+			std::function<void()> stop;
+			std::vector<std::thread>& threads;
+			~Joiner() {
+				stop();
+				for (auto& thread : threads) thread.join();
 			}
+		} joiner { [&] {
+			std::lock_guard lock(mutex);
+			nextRequest = requests.size();
+		}, threads };
+
+		if (threadCount > 1) {
+			for (size_t i = 0; i < threadCount; i++) handlers.emplace_back();
+			for (auto& handler : handlers) threads.emplace_back(worker, std::ref(handler));
+		} else
+			worker(gpgme);
+
+		for (size_t i = 0; i < requests.size(); i++) {
+			std::unique_lock lock(mutex);
+			readyChanged.wait(lock, [&]{ return ready[i]; });
+			lock.unlock();
+			onResult(i, results[i]);
 		}
 	}
 
+	// Streams the whole decrypted file to fd, without keeping it in memory
+	void decryptContents(const fs::path& path, int fd) {
+		gpgme.decrypt(path, fd);
+	}
+
 	void serializeEntry(const PasswordEntry& entry, Notifications notifier) {
 		std::stringstream entryContent;
 		entryContent << entry.password << '\n';
@@ -188,7 +474,7 @@ public:
 
 		if (fs::is_directory(servicePath)) {
 			fs::path userFilePath = withGpgExtension(servicePath / entry.username);
-			gpgme.encrypt(entryContent.str(), userFilePath);
+			encryptEntry(entryContent.str(), userFilePath);
 			notifier.create("passDmenu", "Created directory service: " + userFilePath.native()).timeout(5000).show();
 		} else {
 			bool serviceFileExists = fs::exists(serviceFilePath);
@@ -196,7 +482,7 @@ public:
 				PasswordEntry existingServiceFile(serviceFilePath);
 				decryptEntry(existingServiceFile);
 				if (existingServiceFile.username == entry.username) {
-					gpgme.encrypt(entryContent.str(), serviceFilePath);
+					encryptEntry(entryContent.str(), serviceFilePath);
 					notifier.create("passDmenu", "Modified service file: " + serviceFilePath.native()).timeout(5000).show();
 				} else {
 					fs::create_directory(servicePath);
@@ -207,11 +493,11 @@ public:
 					notifier.create("passDmenu", "Moved service file to: " + serviceFileNewPath.native()).timeout(5000).show();
 
 					const auto newUserFilePath = withGpgExtension(servicePath / entry.username);
-					gpgme.encrypt(entryContent.str(), newUserFilePath);
+					encryptEntry(entryContent.str(), newUserFilePath);
 					notifier.create("passDmenu", "Created user file: " + newUserFilePath.native()).timeout(5000).show();
 				}
 			} else {
-				gpgme.encrypt(entryContent.str(), serviceFilePath);
+				encryptEntry(entryContent.str(), serviceFilePath);
 				notifier.create("passDmenu", "Created service file: " + serviceFilePath.native()).timeout(5000).show();
 			}
 		}
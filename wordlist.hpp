@@ -0,0 +1,208 @@
+#pragma once
+
+#include <string_view>
+
+// Built in wordlist for diceware passphrases, one word per line
+constexpr static std::string_view builtinWordlist =
+	"able\nabout\nabove\naccept\naccount\nacid\nacross\nact\naction\nactive\n"
+	"actor\nadapt\nadd\naddress\nadjust\nadmit\nadult\nadvice\nafford\nafraid\n"
+	"after\nagain\nage\nagent\nagree\nahead\naim\nair\nairport\nalarm\n"
+	"album\nalert\nalien\nalive\nalley\nallow\nalmost\nalone\nalong\nalready\n"
+	"also\nalter\nalways\namazing\namber\namong\namount\nanchor\nancient\nanger\n"
+	"angle\nangry\nanimal\nankle\nannual\nanswer\nantenna\nanvil\nany\napart\n"
+	"apple\napril\napron\narch\narctic\narea\narena\nargue\narm\narmor\n"
+	"army\naround\narrange\narrest\narrive\narrow\nart\nartist\nash\naside\n"
+	"ask\nasleep\naspect\nassist\natom\nattach\nattack\nattend\nattic\naugust\n"
+	"aunt\nauthor\nauto\nautumn\naverage\navocado\navoid\nawake\naward\naware\n"
+	"away\nawful\naxis\nbaby\nbacon\nbadge\nbag\nbake\nbalance\nbalcony\n"
+	"ball\nbamboo\nbanana\nband\nbank\nbanner\nbar\nbarely\nbargain\nbarn\n"
+	"barrel\nbase\nbasin\nbasket\nbattle\nbeach\nbeam\nbean\nbear\nbeard\n"
+	"beast\nbeat\nbeauty\nbecome\nbed\nbee\nbeef\nbefore\nbegin\nbehave\n"
+	"behind\nbell\nbelly\nbelong\nbelow\nbelt\nbench\nbend\nbenefit\nberry\n"
+	"best\nbetter\nbetween\nbeyond\nbicycle\nbid\nbike\nbind\nbiology\nbird\n"
+	"birth\nbiscuit\nbitter\nblack\nblade\nblame\nblanket\nblast\nbleak\nbless\n"
+	"blind\nblood\nblossom\nblouse\nblue\nblur\nblush\nboard\nboat\nbody\n"
+	"boil\nbold\nbolt\nbone\nbonus\nbook\nboost\nboot\nborder\nboring\n"
+	"borrow\nboss\nbottle\nbottom\nbounce\nbox\nboy\nbracket\nbrain\nbrand\n"
+	"brass\nbrave\nbread\nbreeze\nbrick\nbridge\nbrief\nbright\nbring\nbrisk\n"
+	"broccoli\nbroken\nbronze\nbroom\nbrother\nbrown\nbrush\nbubble\nbucket\nbuddy\n"
+	"budget\nbuffalo\nbuild\nbulb\nbulk\nbundle\nbunker\nburden\nburger\nburst\n"
+	"bus\nbush\nbusy\nbutter\nbuyer\nbuzz\ncabbage\ncabin\ncable\ncactus\n"
+	"cage\ncake\ncall\ncalm\ncamera\ncamp\ncanal\ncancel\ncandle\ncandy\n"
+	"cannon\ncanoe\ncanvas\ncanyon\ncapable\ncapital\ncaptain\ncar\ncarbon\ncard\n"
+	"cargo\ncarpet\ncarry\ncart\ncase\ncash\ncastle\ncasual\ncat\ncatalog\n"
+	"catch\ncattle\ncause\ncaution\ncave\nceiling\ncelery\ncement\ncensus\ncentury\n"
+	"cereal\ncertain\nchair\nchalk\nchampion\nchange\nchannel\nchaos\nchapter\ncharge\n"
+	"chase\ncheap\ncheck\ncheese\nchef\ncherry\nchest\nchicken\nchief\nchild\n"
+	"chimney\nchoice\nchoose\nchunk\ncider\ncinema\ncircle\ncitizen\ncity\ncivil\n"
+	"claim\nclap\nclarify\nclaw\nclay\nclean\nclerk\nclever\nclick\nclient\n"
+	"cliff\nclimb\nclinic\nclip\nclock\nclose\ncloth\ncloud\nclown\nclub\n"
+	"clump\ncluster\nclutch\ncoach\ncoast\ncoconut\ncode\ncoffee\ncoil\ncoin\n"
+	"collect\ncolor\ncolumn\ncombine\ncomfort\ncomic\ncommon\ncompany\nconcert\nconduct\n"
+	"confirm\ncongress\nconnect\nconsider\ncontrol\nconvince\ncook\ncool\ncopper\ncopy\n"
+	"coral\ncore\ncorn\ncorrect\ncost\ncotton\ncouch\ncountry\ncouple\ncourse\n"
+	"cousin\ncover\ncoyote\ncrack\ncradle\ncraft\ncram\ncrane\ncrash\ncrater\n"
+	"crawl\ncrazy\ncream\ncredit\ncreek\ncrew\ncricket\ncrime\ncrisp\ncritic\n"
+	"crop\ncross\ncrouch\ncrowd\ncrucial\ncruel\ncruise\ncrumble\ncrunch\ncrush\n"
+	"cry\ncrystal\ncube\nculture\ncup\ncupboard\ncurious\ncurrent\ncurtain\ncurve\n"
+	"cushion\ncustom\ncute\ncycle\ndad\ndamage\ndamp\ndance\ndanger\ndaring\n"
+	"dash\ndaughter\ndawn\nday\ndeal\ndebate\ndebris\ndecade\ndecember\ndecide\n"
+	"decline\ndecorate\ndecrease\ndeer\ndefense\ndefine\ndefy\ndegree\ndelay\ndeliver\n"
+	"demand\ndenial\ndentist\ndeny\ndepart\ndepend\ndeposit\ndepth\ndeputy\nderive\n"
+	"describe\ndesert\ndesign\ndesk\ndespair\ndestroy\ndetail\ndetect\ndevelop\ndevice\n"
+	"devote\ndiagram\ndial\ndiamond\ndiary\ndice\ndiesel\ndiet\ndiffer\ndigital\n"
+	"dignity\ndilemma\ndinner\ndinosaur\ndirect\ndirt\ndisagree\ndiscover\ndisease\ndish\n"
+	"dismiss\ndisorder\ndisplay\ndistance\ndivert\ndivide\ndivorce\ndizzy\ndoctor\ndocument\n"
+	"dog\ndoll\ndolphin\ndomain\ndonate\ndonkey\ndonor\ndoor\ndose\ndouble\n"
+	"dove\ndraft\ndragon\ndrama\ndrastic\ndraw\ndream\ndress\ndrift\ndrill\n"
+	"drink\ndrip\ndrive\ndrop\ndrum\ndry\nduck\ndune\nduring\ndust\n"
+	"dutch\nduty\ndwarf\ndynamic\neager\neagle\nearly\nearn\nearth\neasily\n"
+	"east\neasy\necho\necology\neconomy\nedge\nedit\neducate\neffort\negg\n"
+	"eight\neither\nelbow\nelder\nelectric\nelegant\nelement\nelephant\nelevator\nelite\n"
+	"else\nembark\nembody\nembrace\nemerge\nemotion\nemploy\nempower\nempty\nenable\n"
+	"enact\nend\nendless\nendorse\nenemy\nenergy\nenforce\nengage\nengine\nenhance\n"
+	"enjoy\nenlist\nenough\nenrich\nenroll\nensure\nenter\nentire\nentry\nenvelope\n"
+	"episode\nequal\nequip\nera\nerase\nerode\nerosion\nerror\nerupt\nescape\n"
+	"essay\nessence\nestate\neternal\nethics\nevidence\nevil\nevoke\nevolve\nexact\n"
+	"example\nexcess\nexchange\nexcite\nexclude\nexcuse\nexecute\nexercise\nexhaust\nexhibit\n"
+	"exile\nexist\nexit\nexotic\nexpand\nexpect\nexpire\nexplain\nexpose\nexpress\n"
+	"extend\nextra\neye\neyebrow\nfabric\nface\nfaculty\nfade\nfaint\nfaith\n"
+	"fall\nfalse\nfame\nfamily\nfamous\nfan\nfancy\nfantasy\nfarm\nfashion\n"
+	"fat\nfatal\nfather\nfatigue\nfault\nfavorite\nfeature\nfebruary\nfederal\nfee\n"
+	"feed\nfeel\nfemale\nfence\nfestival\nfetch\nfever\nfew\nfiber\nfiction\n"
+	"field\nfigure\nfile\nfilm\nfilter\nfinal\nfind\nfine\nfinger\nfinish\n"
+	"fire\nfirm\nfirst\nfiscal\nfish\nfit\nfitness\nfix\nflag\nflame\n"
+	"flash\nflat\nflavor\nflee\nflight\nflip\nfloat\nflock\nfloor\nflower\n"
+	"fluid\nflush\nfly\nfoam\nfocus\nfog\nfoil\nfold\nfollow\nfood\n"
+	"foot\nforce\nforest\nforget\nfork\nfortune\nforum\nforward\nfossil\nfoster\n"
+	"found\nfox\nfragile\nframe\nfrequent\nfresh\nfriend\nfringe\nfrog\nfront\n"
+	"frost\nfrown\nfrozen\nfruit\nfuel\nfun\nfunny\nfurnace\nfury\nfuture\n"
+	"gadget\ngain\ngalaxy\ngallery\ngame\ngap\ngarage\ngarbage\ngarden\ngarlic\n"
+	"garment\ngas\ngasp\ngate\ngather\ngauge\ngaze\ngeneral\ngenius\ngenre\n"
+	"gentle\ngenuine\ngesture\nghost\ngiant\ngift\ngiggle\nginger\ngiraffe\ngirl\n"
+	"give\nglad\nglance\nglare\nglass\nglide\nglimpse\nglobe\ngloom\nglory\n"
+	"glove\nglow\nglue\ngoat\ngoddess\ngold\ngood\ngoose\ngorilla\ngospel\n"
+	"gossip\ngovern\ngown\ngrab\ngrace\ngrain\ngrant\ngrape\ngrass\ngravity\n"
+	"great\ngreen\ngrid\ngrief\ngrit\ngrocery\ngroup\ngrow\ngrunt\nguard\n"
+	"guess\nguide\nguilt\nguitar\ngym\nhabit\nhair\nhalf\nhammer\nhamster\n"
+	"hand\nhappy\nharbor\nhard\nharsh\nharvest\nhat\nhave\nhawk\nhazard\n"
+	"head\nhealth\nheart\nheavy\nhedgehog\nheight\nhello\nhelmet\nhelp\nhen\n"
+	"hero\nhidden\nhigh\nhill\nhint\nhip\nhire\nhistory\nhobby\nhockey\n"
+	"hold\nhole\nholiday\nhollow\nhome\nhoney\nhood\nhope\nhorn\nhorror\n"
+	"horse\nhospital\nhost\nhotel\nhour\nhover\nhub\nhuge\nhuman\nhumble\n"
+	"humor\nhundred\nhungry\nhunt\nhurdle\nhurry\nhurt\nhusband\nhybrid\nice\n"
+	"icon\nidea\nidentify\nidle\nignore\nill\nillegal\nillness\nimage\nimitate\n"
+	"immense\nimmune\nimpact\nimpose\nimprove\nimpulse\ninch\ninclude\nincome\nincrease\n"
+	"index\nindicate\nindoor\nindustry\ninfant\ninflict\ninform\ninhale\ninherit\ninitial\n"
+	"inject\ninjury\ninmate\ninner\ninnocent\ninput\ninquiry\ninsect\ninside\ninspire\n"
+	"install\nintact\ninterest\ninto\ninvest\ninvite\ninvolve\niron\nisland\nisolate\n"
+	"issue\nitem\nivory\njacket\njaguar\njar\njazz\njealous\njeans\njelly\n"
+	"jewel\njob\njoin\njoke\njourney\njoy\njudge\njuice\njump\njungle\n"
+	"junior\njunk\njust\nkangaroo\nkeen\nkeep\nketchup\nkey\nkick\nkid\n"
+	"kidney\nkind\nkingdom\nkiss\nkit\nkitchen\nkite\nkitten\nkiwi\nknee\n"
+	"knife\nknock\nknow\nlab\nlabel\nlabor\nladder\nlady\nlake\nlamp\n"
+	"language\nlaptop\nlarge\nlater\nlatin\nlaugh\nlaundry\nlava\nlaw\nlawn\n"
+	"lawsuit\nlayer\nlazy\nleader\nleaf\nlearn\nleave\nlecture\nleft\nleg\n"
+	"legal\nlegend\nleisure\nlemon\nlend\nlength\nlens\nleopard\nlesson\nletter\n"
+	"level\nliar\nliberty\nlibrary\nlicense\nlife\nlift\nlight\nlike\nlimb\n"
+	"limit\nlink\nlion\nliquid\nlist\nlittle\nlive\nlizard\nload\nloan\n"
+	"lobster\nlocal\nlock\nlogic\nlonely\nlong\nloop\nlottery\nloud\nlounge\n"
+	"love\nloyal\nlucky\nluggage\nlumber\nlunar\nlunch\nluxury\nlyrics\nmachine\n"
+	"mad\nmagic\nmagnet\nmaid\nmail\nmain\nmajor\nmake\nmammal\nman\n"
+	"manage\nmandate\nmango\nmansion\nmanual\nmaple\nmarble\nmarch\nmargin\nmarine\n"
+	"market\nmarriage\nmask\nmass\nmaster\nmatch\nmaterial\nmath\nmatrix\nmatter\n"
+	"maximum\nmaze\nmeadow\nmean\nmeasure\nmeat\nmechanic\nmedal\nmedia\nmelody\n"
+	"melt\nmember\nmemory\nmention\nmenu\nmercy\nmerge\nmerit\nmerry\nmesh\n"
+	"message\nmetal\nmethod\nmiddle\nmidnight\nmilk\nmillion\nmimic\nmind\nminimum\n"
+	"minor\nminute\nmiracle\nmirror\nmisery\nmiss\nmistake\nmix\nmixed\nmixture\n"
+	"mobile\nmodel\nmodify\nmom\nmoment\nmonitor\nmonkey\nmonster\nmonth\nmoon\n"
+	"moral\nmore\nmorning\nmosquito\nmother\nmotion\nmotor\nmountain\nmouse\nmove\n"
+	"movie\nmuch\nmuffin\nmule\nmultiply\nmuscle\nmuseum\nmushroom\nmusic\nmust\n"
+	"mutual\nmyself\nmystery\nmyth\nnaive\nname\nnapkin\nnarrow\nnasty\nnation\n"
+	"nature\nnear\nneck\nneed\nnegative\nneglect\nneither\nnephew\nnerve\nnest\n"
+	"net\nnetwork\nneutral\nnever\nnews\nnext\nnice\nnight\nnoble\nnoise\n"
+	"nominee\nnoodle\nnormal\nnorth\nnose\nnotable\nnote\nnothing\nnotice\nnovel\n"
+	"now\nnuclear\nnumber\nnurse\nnut\noak\nobey\nobject\noblige\nobscure\n"
+	"observe\nobtain\nobvious\noccur\nocean\noctober\nodor\noff\noffer\noffice\n"
+	"often\noil\nokay\nold\nolive\nolympic\nomit\nonce\none\nonion\n"
+	"online\nonly\nopen\nopera\nopinion\noppose\noption\norange\norbit\norchard\n"
+	"order\nordinary\norgan\norient\noriginal\norphan\nostrich\nother\noutdoor\nouter\n"
+	"output\noutside\noval\noven\nover\nown\nowner\noxygen\noyster\nozone\n"
+	"pact\npaddle\npage\npair\npalace\npalm\npanda\npanel\npanic\npanther\n"
+	"paper\nparade\nparent\npark\nparrot\nparty\npass\npatch\npath\npatient\n"
+	"patrol\npattern\npause\npave\npayment\npeace\npeanut\npear\npeasant\npelican\n"
+	"pen\npenalty\npencil\npeople\npepper\nperfect\npermit\nperson\npet\nphone\n"
+	"photo\nphrase\nphysical\npiano\npicnic\npicture\npiece\npig\npigeon\npill\n"
+	"pilot\npink\npioneer\npipe\npitch\npizza\nplace\nplanet\nplastic\nplate\n"
+	"play\nplease\npledge\npluck\nplug\nplunge\npoem\npoet\npoint\npolar\n"
+	"pole\npolice\npond\npony\npool\npopular\nportion\nposition\npossible\npost\n"
+	"potato\npottery\npoverty\npowder\npower\npractice\npraise\npredict\nprefer\nprepare\n"
+	"present\npretty\nprevent\nprice\npride\nprimary\nprint\npriority\nprison\nprivate\n"
+	"prize\nproblem\nprocess\nproduce\nprofit\nprogram\nproject\npromote\nproof\nproperty\n"
+	"prosper\nprotect\nproud\nprovide\npublic\npudding\npull\npulp\npulse\npumpkin\n"
+	"punch\npupil\npuppy\npurchase\npurity\npurpose\npurse\npush\nput\npuzzle\n"
+	"pyramid\nquality\nquantum\nquarter\nquestion\nquick\nquit\nquiz\nquote\nrabbit\n"
+	"raccoon\nrace\nrack\nradar\nradio\nrail\nrain\nraise\nrally\nramp\n"
+	"ranch\nrandom\nrange\nrapid\nrare\nrate\nrather\nraven\nraw\nrazor\n"
+	"ready\nreal\nreason\nrebel\nrebuild\nrecall\nreceive\nrecipe\nrecord\nrecycle\n"
+	"reduce\nreflect\nreform\nrefuse\nregion\nregret\nregular\nreject\nrelax\nrelease\n"
+	"relief\nrely\nremain\nremember\nremind\nremove\nrender\nrenew\nrent\nreopen\n"
+	"repair\nrepeat\nreplace\nreport\nrequire\nrescue\nresemble\nresist\nresource\nresponse\n"
+	"result\nretire\nretreat\nreturn\nreunion\nreveal\nreview\nreward\nrhythm\nrib\n"
+	"ribbon\nrice\nrich\nride\nridge\nright\nrigid\nring\nriot\nripple\n"
+	"risk\nritual\nrival\nriver\nroad\nroast\nrobot\nrobust\nrocket\nromance\n"
+	"roof\nrookie\nroom\nrose\nrotate\nrough\nround\nroute\nroyal\nrubber\n"
+	"rude\nrug\nrule\nrun\nrunway\nrural\nsad\nsaddle\nsadness\nsafe\n"
+	"sail\nsalad\nsalmon\nsalon\nsalt\nsalute\nsame\nsample\nsand\nsatisfy\n"
+	"sauce\nsausage\nsave\nsay\nscale\nscan\nscare\nscatter\nscene\nscheme\n"
+	"school\nscience\nscissors\nscorpion\nscout\nscrap\nscreen\nscript\nscrub\nsea\n"
+	"search\nseason\nseat\nsecond\nsecret\nsection\nsecurity\nseed\nseek\nsegment\n"
+	"select\nsell\nseminar\nsenior\nsense\nsentence\nseries\nservice\nsession\nsettle\n"
+	"setup\nseven\nshadow\nshaft\nshallow\nshare\nshed\nshell\nsheriff\nshield\n"
+	"shift\nshine\nship\nshiver\nshock\nshoe\nshoot\nshop\nshort\nshoulder\n"
+	"shove\nshrimp\nshrug\nshuffle\nshy\nsibling\nsick\nside\nsiege\nsight\n"
+	"sign\nsilent\nsilk\nsilly\nsilver\nsimilar\nsimple\nsince\nsing\nsiren\n"
+	"sister\nsituate\nsix\nsize\nskate\nsketch\nski\nskill\nskin\nskirt\n"
+	"skull\nslab\nslam\nsleep\nslender\nslice\nslide\nslight\nslim\nslogan\n"
+	"slot\nslow\nslush\nsmall\nsmart\nsmile\nsmoke\nsmooth\nsnack\nsnake\n"
+	"snap\nsniff\nsnow\nsoap\nsoccer\nsocial\nsock\nsoda\nsoft\nsolar\n"
+	"soldier\nsolid\nsolution\nsolve\nsomeone\nsong\nsoon\nsorry\nsort\nsoul\n"
+	"sound\nsoup\nsource\nsouth\nspace\nspare\nspatial\nspawn\nspeak\nspecial\n"
+	"speed\nspell\nspend\nsphere\nspice\nspider\nspike\nspin\nspirit\nsplit\n"
+	"spoil\nsponsor\nspoon\nsport\nspot\nspray\nspread\nspring\nspy\nsquare\n"
+	"squeeze\nsquirrel\nstable\nstadium\nstaff\nstage\nstairs\nstamp\nstand\nstart\n"
+	"state\nstay\nsteak\nsteel\nstem\nstep\nstereo\nstick\nstill\nsting\n"
+	"stock\nstomach\nstone\nstool\nstory\nstove\nstrategy\nstreet\nstrike\nstrong\n"
+	"struggle\nstudent\nstuff\nstumble\nstyle\nsubject\nsubmit\nsubway\nsuccess\nsuch\n"
+	"sudden\nsuffer\nsugar\nsuggest\nsuit\nsummer\nsun\nsunny\nsunset\nsuper\n"
+	"supply\nsupreme\nsure\nsurface\nsurge\nsurprise\nsurround\nsurvey\nsuspect\nsustain\n"
+	"swallow\nswamp\nswap\nswarm\nswear\nsweet\nswift\nswim\nswing\nswitch\n"
+	"sword\nsymbol\nsymptom\nsyrup\nsystem\ntable\ntackle\ntag\ntail\ntalent\n"
+	"talk\ntank\ntape\ntarget\ntask\ntaste\ntattoo\ntaxi\nteach\nteam\n"
+	"tell\nten\ntenant\ntennis\ntent\nterm\ntest\ntext\nthank\nthat\n"
+	"theme\nthen\ntheory\nthere\nthey\nthing\nthis\nthought\nthree\nthrive\n"
+	"throw\nthumb\nthunder\nticket\ntide\ntiger\ntilt\ntimber\ntime\ntiny\n"
+	"tip\ntired\ntissue\ntitle\ntoast\ntoday\ntoddler\ntoe\ntogether\ntoilet\n"
+	"token\ntomato\ntomorrow\ntone\ntongue\ntonight\ntool\ntooth\ntop\ntopic\n"
+	"topple\ntorch\ntornado\ntortoise\ntoss\ntotal\ntourist\ntoward\ntower\ntown\n"
+	"toy\ntrack\ntrade\ntraffic\ntragic\ntrain\ntransfer\ntrap\ntrash\ntravel\n"
+	"tray\ntreat\ntree\ntrend\ntrial\ntribe\ntrick\ntrigger\ntrim\ntrip\n"
+	"trophy\ntrouble\ntruck\ntrue\ntruly\ntrumpet\ntrust\ntruth\ntry\ntube\n"
+	"tuition\ntumble\ntuna\ntunnel\nturkey\nturn\nturtle\ntwelve\ntwenty\ntwice\n"
+	"twin\ntwist\ntwo\ntype\ntypical\numbrella\nunable\nunaware\nuncle\nuncover\n"
+	"under\nundo\nunfair\nunfold\nunhappy\nuniform\nunique\nunit\nuniverse\nunknown\n"
+	"unlock\nuntil\nunusual\nunveil\nupdate\nupgrade\nuphold\nupon\nupper\nupset\n"
+	"urban\nurge\nusage\nuse\nused\nuseful\nuseless\nusual\nutility\nvacant\n"
+	"vacuum\nvague\nvalid\nvalley\nvalve\nvan\nvanish\nvapor\nvarious\nvast\n"
+	"vault\nvehicle\nvelvet\nvendor\nventure\nvenue\nverb\nverify\nversion\nvery\n"
+	"vessel\nveteran\nviable\nvibrant\nvicious\nvictory\nvideo\nview\nvillage\nvintage\n"
+	"violin\nvirtual\nvirus\nvisa\nvisit\nvisual\nvital\nvivid\nvocal\nvoice\n"
+	"void\nvolcano\nvolume\nvote\nvoyage\nwage\nwagon\nwait\nwalk\nwall\n"
+	"walnut\nwant\nwarfare\nwarm\nwarrior\nwash\nwasp\nwaste\nwater\nwave\n"
+	"way\nwealth\nwear\nweasel\nweather\nweb\nwedding\nweekend\nweird\nwelcome\n"
+	"west\nwet\nwhale\nwhat\nwheat\nwheel\nwhen\nwhere\nwhip\nwhisper\n"
+	"wide\nwidth\nwife\nwild\nwill\nwin\nwindow\nwine\nwing\nwink\n"
+	"winner\nwinter\nwire\nwisdom\nwise\nwish\nwitness\nwolf\nwoman\nwonder\n"
+	"wood\nwool\nword\nwork\nworld\nworry\nworth\nwrap\nwreck\nwrestle\n"
+	"wrist\nwrite\nwrong\nyard\nyear\nyellow\nyou\nyoung\nyouth\nzebra\n"
+	"zero\nzone\nzoo\n";